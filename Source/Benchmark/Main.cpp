@@ -0,0 +1,142 @@
+#include "Client.h"
+#include "LocalEndpoints.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <stdexcept>
+
+// Compares the same-host transports against loopback TCP. Needs a running Server; every client
+// sends TEXT messages to itself so each one makes a full trip through Session routing.
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    struct Counter
+    {
+        std::mutex mutex;
+        std::condition_variable cv;
+        uint64_t received = 0;
+
+        // A dropped reply must fail the run instead of hanging it.
+        void waitFor(uint64_t count)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            if (!cv.wait_for(lock, std::chrono::seconds(10), [&] { return received >= count; }))
+            {
+                throw std::runtime_error("Timed out waiting for replies: got "
+                                         + std::to_string(received) + " of "
+                                         + std::to_string(count));
+            }
+        }
+    };
+
+    void measure(const std::string& label, Client& client, Counter& counter, int count)
+    {
+        const std::string receiver = "bench-" + label;
+        const std::string payload(64, 'x');
+        uint64_t expected = 0;
+
+        // Round trip latency, one message in flight.
+        std::vector<double> latencies;
+        latencies.reserve(count);
+        for (int i = 0; i < count; ++i)
+        {
+            const auto start = Clock::now();
+            client.sendText(receiver, payload);
+            counter.waitFor(++expected);
+            latencies.push_back(
+                std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+        }
+        std::sort(latencies.begin(), latencies.end());
+
+        // Throughput, as many messages in flight as the transport allows.
+        const int burst = count * 10;
+        const auto start = Clock::now();
+        for (int i = 0; i < burst; ++i)
+        {
+            client.sendText(receiver, payload);
+        }
+        expected += burst;
+        counter.waitFor(expected);
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        std::cout << label << ": p50 " << latencies[latencies.size() / 2] << " us, p99 "
+                  << latencies[latencies.size() * 99 / 100] << " us, "
+                  << static_cast<uint64_t>(burst / seconds) << " msg/s" << std::endl;
+    }
+
+    void runBenchmark(const std::string& label, Client& client, int count)
+    {
+        Counter counter;
+        client.setName("bench-" + label);
+        client.setMessageHandler(
+            [&counter](const nlohmann::json&)
+            {
+                std::lock_guard<std::mutex> lock(counter.mutex);
+                ++counter.received;
+                counter.cv.notify_one();
+            });
+        client.registerName();
+        client.startReceiving();
+        std::thread ioThread([&client]() { client.run(); });
+
+        try
+        {
+            measure(label, client, counter, count);
+        }
+        catch (...)
+        {
+            client.stop();
+            ioThread.join();
+            throw;
+        }
+
+        client.stop();
+        ioThread.join();
+    }
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    spdlog::set_level(spdlog::level::warn);
+
+    try
+    {
+        const int count = argc > 1 ? std::stoi(argv[1]) : 10000;
+        if (count < 1)
+        {
+            spdlog::error("Message count must be at least 1");
+            return 1;
+        }
+
+        {
+            Client client("127.0.0.1", "12345");
+            runBenchmark("tcp", client, count);
+        }
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+        {
+            Client client{ std::filesystem::path(localSocketPath) };
+            runBenchmark("local", client, count);
+        }
+#endif
+#if defined(__linux__)
+        {
+            Client client(std::filesystem::path(sharedMemorySocketPath),
+                          Client::Transport::SharedMemory);
+            runBenchmark("shm", client, count);
+        }
+#endif
+    }
+    catch (const std::exception& e)
+    {
+        spdlog::error("Benchmark failed: {}", e.what());
+        return 1;
+    }
+
+    return 0;
+}
@@ -2,13 +2,58 @@
 
 #include <spdlog/spdlog.h>
 
+#include <array>
+#include <chrono>
+#include <cstring>
 #include <fstream>
+#include <thread>
+
+#if defined(__linux__)
+#include "ShmRing.h"
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+constexpr auto ringTimeout = std::chrono::seconds(5);
+#endif
 
 Client::Client(const std::string& host, const std::string& port) : _socket{ _ioContext }
 {
+    boost::asio::ip::tcp::socket socket(_ioContext);
     boost::asio::ip::tcp::resolver resolver(_ioContext);
-    boost::asio::connect(_socket, resolver.resolve(host, port));
+    boost::asio::connect(socket, resolver.resolve(host, port));
+    socket.set_option(boost::asio::ip::tcp::no_delay(true));
+    _socket = std::move(socket);
+}
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+Client::Client(const std::filesystem::path& socketPath, Transport transport)
+    : _socket{ _ioContext }
+{
+    boost::asio::local::stream_protocol::socket socket(_ioContext);
+    socket.connect(boost::asio::local::stream_protocol::endpoint(socketPath.string()));
+
+    if (transport == Transport::SharedMemory)
+    {
+#if defined(__linux__)
+        _ring = ShmRing::create();
+        _doorbell.reset(eventfd(0, EFD_CLOEXEC));
+        if (!_doorbell)
+        {
+            throw std::system_error(errno, std::generic_category(), "eventfd");
+        }
+        ShmRing::sendDescriptors(socket.native_handle(), _ring->fd(), _doorbell.get());
+#else
+        throw std::runtime_error("Shared memory transport is only available on Linux");
+#endif
+    }
+
+    _socket = std::move(socket);
 }
+#endif
+
+Client::~Client() = default;
 
 void Client::registerName()
 {
@@ -46,6 +91,11 @@ void Client::startReceiving()
                             try
                             {
                                 nlohmann::json msg = nlohmann::json::parse(json_text);
+                                if (_messageHandler)
+                                {
+                                    _messageHandler(msg);
+                                }
+
                                 std::string type = msg["type"];
                                 std::string sender = msg.value("sender", "unknown");
                                 spdlog::info("Start handle message type: {}", type);
@@ -127,11 +177,70 @@ void Client::sendJson(const nlohmann::json& j)
 {
     std::string serialized = j.dump();
     uint32_t len = serialized.size();
-    boost::asio::write(_socket, boost::asio::buffer(&len, sizeof(len)));
-    boost::asio::write(_socket, boost::asio::buffer(serialized));
+
+#if defined(__linux__)
+    if (_ring && sizeof(len) + len <= _ring->capacity())
+    {
+        pushToRing(serialized);
+        spdlog::info("Sent {} bytes", len);
+        return;
+    }
+
+    // Too big for the ring: an empty marker frame tells the server that the next message comes
+    // over the socket, so it processes both channels in the order they were sent.
+    if (_ring)
+    {
+        pushToRing(std::string());
+    }
+#endif
+
+    const std::array<boost::asio::const_buffer, 2> buffers
+        = { boost::asio::buffer(&len, sizeof(len)), boost::asio::buffer(serialized) };
+    boost::asio::write(_socket, buffers);
     spdlog::info("Sent {} bytes", len);
 }
 
+#if defined(__linux__)
+void Client::pushToRing(const std::string& serialized)
+{
+    bool wasEmpty = false;
+    waitForRing([&]() { return _ring->tryPush(serialized, wasEmpty); });
+
+    // The server only sleeps on the doorbell once it has emptied the ring.
+    if (wasEmpty)
+    {
+        const uint64_t one = 1;
+        if (write(_doorbell.get(), &one, sizeof(one)) != sizeof(one))
+        {
+            spdlog::error("Failed to ring doorbell: {}", std::strerror(errno));
+        }
+    }
+}
+
+void Client::waitForRing(const std::function<bool()>& ready)
+{
+    // The server may have crashed, dropped the session or given up on a corrupted ring,
+    // so never spin forever waiting for it to drain.
+    const auto deadline = std::chrono::steady_clock::now() + ringTimeout;
+    for (unsigned spins = 0; !ready(); ++spins)
+    {
+        if (spins % 1024 == 0)
+        {
+            pollfd control{ _socket.native_handle(), POLLRDHUP, 0 };
+            if (poll(&control, 1, 0) < 0 || (control.revents & (POLLRDHUP | POLLHUP | POLLERR)))
+            {
+                throw std::runtime_error("Server closed the shared memory control socket");
+            }
+            if (std::chrono::steady_clock::now() > deadline)
+            {
+                throw std::runtime_error("Timed out waiting for the server to drain the ring");
+            }
+        }
+        std::this_thread::yield();
+    }
+}
+#endif
+
 std::string Client::base64Encode(const std::vector<unsigned char>& bytes_to_encode)
 {
     const std::string base64_chars
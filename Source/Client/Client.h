@@ -3,15 +3,38 @@
 #include <boost/asio.hpp>
 #include <nlohmann/json.hpp>
 #include <filesystem>
+#include <functional>
+
+#if defined(__linux__)
+#include "UniqueFd.h"
+
+class ShmRing;
+#endif
 
 class Client
 {
 public:
+    enum class Transport
+    {
+        Local,       // Unix domain socket
+        SharedMemory // Unix domain socket for replies, shared memory ring for outgoing messages
+    };
+
     Client(const std::string& host, const std::string& port);
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+    explicit Client(const std::filesystem::path& socketPath,
+                    Transport transport = Transport::Local);
+#endif
+    ~Client();
 
     void setName(const std::string& name) { _senderName = name; }
+    void setMessageHandler(std::function<void(const nlohmann::json&)> handler)
+    {
+        _messageHandler = std::move(handler);
+    }
 
     void run() { _ioContext.run(); }
+    void stop() { _ioContext.stop(); }
 
     void registerName();
     void startReceiving();
@@ -21,6 +44,11 @@ public:
 
 private:
     void sendJson(const nlohmann::json& j);
+#if defined(__linux__)
+    void pushToRing(const std::string& serialized);
+    // Spins until ready() holds; throws if the server stops draining the ring.
+    void waitForRing(const std::function<bool()>& ready);
+#endif
     std::string base64Encode(const std::vector<unsigned char>& bytes_to_encode);
     std::vector<unsigned char> base64Decode(std::string const& encoded_string);
     bool is_base64(unsigned char c);
@@ -28,7 +56,12 @@ private:
 private:
     std::string _senderName{ "unknown" };
     boost::asio::io_context _ioContext;
-    boost::asio::ip::tcp::socket _socket;
+    boost::asio::generic::stream_protocol::socket _socket;
     uint32_t _incomingLength;
     std::vector<unsigned char> _incomingData;
+    std::function<void(const nlohmann::json&)> _messageHandler;
+#if defined(__linux__)
+    std::unique_ptr<ShmRing> _ring;
+    UniqueFd _doorbell;
+#endif
 };
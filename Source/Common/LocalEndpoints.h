@@ -0,0 +1,5 @@
+#pragma once
+
+// Same-host endpoints the server listens on and local clients connect to.
+constexpr const char* localSocketPath = "/tmp/ClientServer.sock";
+constexpr const char* sharedMemorySocketPath = "/tmp/ClientServer.shm.sock";
@@ -0,0 +1,231 @@
+#include "ShmRing.h"
+
+#if defined(__linux__)
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+
+namespace
+{
+    constexpr int requiredSeals = F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL;
+} // namespace
+
+std::unique_ptr<ShmRing> ShmRing::create(std::size_t capacity)
+{
+    if (capacity < 64 || (capacity & (capacity - 1)) != 0)
+    {
+        throw std::invalid_argument("Ring capacity must be a power of two");
+    }
+
+    UniqueFd memFd(memfd_create("ClientServer-ring", MFD_CLOEXEC | MFD_ALLOW_SEALING));
+    if (!memFd)
+    {
+        throw std::system_error(errno, std::generic_category(), "memfd_create");
+    }
+
+    const std::size_t mappingSize = sizeof(Header) + capacity;
+    if (ftruncate(memFd.get(), mappingSize) != 0)
+    {
+        throw std::system_error(errno, std::generic_category(), "ftruncate");
+    }
+
+    // Without the seals the producer could shrink the segment under the server's mapping.
+    if (fcntl(memFd.get(), F_ADD_SEALS, requiredSeals) != 0)
+    {
+        throw std::system_error(errno, std::generic_category(), "fcntl(F_ADD_SEALS)");
+    }
+
+    std::unique_ptr<ShmRing> ring(new ShmRing(std::move(memFd), mappingSize));
+    new (ring->_header) Header{};
+    return ring;
+}
+
+std::unique_ptr<ShmRing> ShmRing::attach(UniqueFd memFd)
+{
+    const int seals = fcntl(memFd.get(), F_GET_SEALS);
+    if (seals < 0 || (seals & requiredSeals) != requiredSeals)
+    {
+        throw std::runtime_error("Shared memory segment is not sealed against resizing");
+    }
+
+    struct stat info{};
+    if (fstat(memFd.get(), &info) != 0)
+    {
+        throw std::system_error(errno, std::generic_category(), "fstat");
+    }
+
+    const std::size_t mappingSize = info.st_size;
+    const std::size_t capacity = mappingSize > sizeof(Header) ? mappingSize - sizeof(Header) : 0;
+    if (capacity < 64 || (capacity & (capacity - 1)) != 0)
+    {
+        throw std::runtime_error("Shared memory segment has invalid size");
+    }
+
+    return std::unique_ptr<ShmRing>(new ShmRing(std::move(memFd), mappingSize));
+}
+
+ShmRing::ShmRing(UniqueFd memFd, std::size_t mappingSize)
+    : _memFd{ std::move(memFd) }, _mappingSize{ mappingSize },
+      _capacity{ mappingSize - sizeof(Header) }
+{
+    void* mapping
+        = mmap(nullptr, _mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, _memFd.get(), 0);
+    if (mapping == MAP_FAILED)
+    {
+        throw std::system_error(errno, std::generic_category(), "mmap");
+    }
+
+    _header = static_cast<Header*>(mapping);
+    _data = static_cast<unsigned char*>(mapping) + sizeof(Header);
+}
+
+ShmRing::~ShmRing()
+{
+    munmap(_header, _mappingSize);
+}
+
+bool ShmRing::empty() const
+{
+    return _header->head.load(std::memory_order_acquire)
+           == _header->tail.load(std::memory_order_acquire);
+}
+
+bool ShmRing::tryPush(const std::string& data, bool& wasEmpty)
+{
+    const uint64_t head = _header->head.load(std::memory_order_relaxed);
+    const uint64_t tail = _header->tail.load(std::memory_order_acquire);
+    const std::size_t frameSize = sizeof(uint32_t) + data.size();
+    if (frameSize > _capacity - (head - tail))
+    {
+        return false;
+    }
+
+    const uint32_t len = data.size();
+    copyIn(head, &len, sizeof(len));
+    copyIn(head + sizeof(len), data.data(), data.size());
+
+    // Publishing head and re-reading tail pairs with the consumer storing tail and re-reading
+    // head, so at least one side sees the other and no doorbell is lost.
+    _header->head.store(head + frameSize, std::memory_order_seq_cst);
+    wasEmpty = _header->tail.load(std::memory_order_seq_cst) == head;
+    return true;
+}
+
+std::optional<std::string> ShmRing::tryPop()
+{
+    const uint64_t tail = _header->tail.load(std::memory_order_relaxed);
+    const uint64_t head = _header->head.load(std::memory_order_seq_cst);
+    if (head == tail)
+    {
+        return std::nullopt;
+    }
+
+    const uint64_t used = head - tail;
+    if (used > _capacity || used < sizeof(uint32_t))
+    {
+        throw std::runtime_error("Ring positions are inconsistent");
+    }
+
+    uint32_t len = 0;
+    copyOut(tail, &len, sizeof(len));
+    if (len > used - sizeof(len))
+    {
+        throw std::runtime_error("Ring frame exceeds written data");
+    }
+
+    std::string data(len, '\0');
+    copyOut(tail + sizeof(len), data.data(), len);
+    _header->tail.store(tail + sizeof(len) + len, std::memory_order_seq_cst);
+    return data;
+}
+
+void ShmRing::copyIn(uint64_t position, const void* src, std::size_t size)
+{
+    const std::size_t offset = position & (_capacity - 1);
+    const std::size_t first = std::min(size, _capacity - offset);
+    std::memcpy(_data + offset, src, first);
+    std::memcpy(_data, static_cast<const unsigned char*>(src) + first, size - first);
+}
+
+void ShmRing::copyOut(uint64_t position, void* dst, std::size_t size) const
+{
+    const std::size_t offset = position & (_capacity - 1);
+    const std::size_t first = std::min(size, _capacity - offset);
+    std::memcpy(dst, _data + offset, first);
+    std::memcpy(static_cast<unsigned char*>(dst) + first, _data, size - first);
+}
+
+void ShmRing::sendDescriptors(int socketFd, int memFd, int eventFd)
+{
+    char byte = 0;
+    iovec iov{ &byte, sizeof(byte) };
+    alignas(cmsghdr) char control[CMSG_SPACE(2 * sizeof(int))]{};
+
+    msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(2 * sizeof(int));
+    const int fds[2] = { memFd, eventFd };
+    std::memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+
+    if (sendmsg(socketFd, &msg, MSG_NOSIGNAL) != sizeof(byte))
+    {
+        throw std::system_error(errno, std::generic_category(), "sendmsg");
+    }
+}
+
+bool ShmRing::receiveDescriptors(int socketFd, UniqueFd& memFd, UniqueFd& eventFd)
+{
+    char byte = 0;
+    iovec iov{ &byte, sizeof(byte) };
+    alignas(cmsghdr) char control[CMSG_SPACE(2 * sizeof(int))]{};
+
+    msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    if (recvmsg(socketFd, &msg, MSG_DONTWAIT | MSG_CMSG_CLOEXEC) != sizeof(byte))
+    {
+        return false;
+    }
+
+    cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    if (!cmsg || cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS)
+    {
+        return false;
+    }
+
+    // Take ownership of whatever arrived so a malformed message does not leak descriptors.
+    const std::size_t count = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+    int fds[2] = { -1, -1 };
+    std::memcpy(fds, CMSG_DATA(cmsg), std::min(count, std::size_t{ 2 }) * sizeof(int));
+    UniqueFd first(fds[0]);
+    UniqueFd second(fds[1]);
+    if (count != 2 || (msg.msg_flags & MSG_CTRUNC))
+    {
+        return false;
+    }
+
+    memFd = std::move(first);
+    eventFd = std::move(second);
+    return true;
+}
+
+#endif
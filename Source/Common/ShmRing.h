@@ -0,0 +1,68 @@
+#pragma once
+
+#if defined(__linux__)
+
+#include "UniqueFd.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+
+// Single-producer/single-consumer byte ring placed in a memfd shared between the client and
+// the server. Each frame is a uint32_t length followed by the JSON payload, like on the socket.
+// The producer rings an eventfd doorbell only when it pushes into an empty ring.
+class ShmRing
+{
+public:
+    static constexpr std::size_t defaultCapacity = 1024 * 1024;
+
+    // Creates a new anonymous segment, capacity must be a power of two.
+    static std::unique_ptr<ShmRing> create(std::size_t capacity = defaultCapacity);
+    // Maps a segment received from the peer; validates its seals and size.
+    static std::unique_ptr<ShmRing> attach(UniqueFd memFd);
+
+    ~ShmRing();
+
+    ShmRing(const ShmRing&) = delete;
+    ShmRing& operator=(const ShmRing&) = delete;
+
+    int fd() const { return _memFd.get(); }
+    std::size_t capacity() const { return _capacity; }
+    bool empty() const;
+
+    // Producer side. Returns false if there is not enough free space right now.
+    // wasEmpty tells whether the consumer may be waiting for the doorbell.
+    bool tryPush(const std::string& data, bool& wasEmpty);
+    // Consumer side. Throws std::runtime_error if the producer wrote an inconsistent frame.
+    std::optional<std::string> tryPop();
+
+    // Pass the segment and the doorbell over a connected Unix domain socket (SCM_RIGHTS).
+    static void sendDescriptors(int socketFd, int memFd, int eventFd);
+    static bool receiveDescriptors(int socketFd, UniqueFd& memFd, UniqueFd& eventFd);
+
+private:
+    // Both processes map the same atomics, which only works if they never fall back to a lock.
+    static_assert(std::atomic<uint64_t>::is_always_lock_free);
+
+    struct Header
+    {
+        alignas(64) std::atomic<uint64_t> head; // written by producer
+        alignas(64) std::atomic<uint64_t> tail; // written by consumer
+    };
+
+    ShmRing(UniqueFd memFd, std::size_t mappingSize);
+
+    void copyIn(uint64_t position, const void* src, std::size_t size);
+    void copyOut(uint64_t position, void* dst, std::size_t size) const;
+
+private:
+    UniqueFd _memFd;
+    std::size_t _mappingSize = 0;
+    std::size_t _capacity = 0;
+    Header* _header = nullptr;
+    unsigned char* _data = nullptr;
+};
+
+#endif
@@ -1,14 +1,24 @@
+#include "LocalEndpoints.h"
 #include "Server.h"
+#include "spdlog/cfg/env.h"
 #include "spdlog/spdlog.h"
 
 #include <boost/asio.hpp>
 
 int main()
 {
+    spdlog::cfg::load_env_levels();
+
     try
     {
         boost::asio::io_context io_context;
         Server server(io_context, 12345);
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+        server.listenLocal(localSocketPath);
+#endif
+#if defined(__linux__)
+        server.listenSharedMemory(sharedMemorySocketPath);
+#endif
 
         std::vector<std::thread> threads;
         int thread_count = std::thread::hardware_concurrency();
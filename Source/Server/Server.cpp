@@ -3,12 +3,44 @@
 
 #include "Session.h"
 
+#if defined(__linux__)
+#include "ShmRing.h"
+#endif
+
+#include <filesystem>
+
+#if defined(__linux__)
+constexpr auto handshakeTimeout = std::chrono::seconds(5);
+#endif
+
 Server::Server(boost::asio::io_context& io_context, short port)
     : _acceptor{ io_context, boost::asio::ip::tcp::endpoint(boost::asio::ip::tcp::v4(), port) }
 {
     accept();
 }
 
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+void Server::listenLocal(const std::string& path)
+{
+    std::filesystem::remove(path);
+    _localAcceptor.emplace(_acceptor.get_executor(),
+                           boost::asio::local::stream_protocol::endpoint(path));
+    spdlog::info("Listening on local socket: {}", path);
+    acceptLocal();
+}
+#endif
+
+#if defined(__linux__)
+void Server::listenSharedMemory(const std::string& path)
+{
+    std::filesystem::remove(path);
+    _shmAcceptor.emplace(_acceptor.get_executor(),
+                         boost::asio::local::stream_protocol::endpoint(path));
+    spdlog::info("Listening for shared memory clients on: {}", path);
+    acceptSharedMemory();
+}
+#endif
+
 void Server::registerClient(const std::string& name, std::shared_ptr<Session> session)
 {
     std::lock_guard<std::mutex> lock(_mutex);
@@ -16,11 +48,15 @@ void Server::registerClient(const std::string& name, std::shared_ptr<Session> se
     spdlog::info("Registered client: {}", name);
 }
 
-void Server::unregisterClient(const std::string& name)
+void Server::unregisterClient(const std::string& name, const Session* session)
 {
     std::lock_guard<std::mutex> lock(_mutex);
-    _clients.erase(name);
-    spdlog::info("Unregistered client: {}", name);
+    auto it = _clients.find(name);
+    if (it != _clients.end() && it->second.get() == session)
+    {
+        _clients.erase(it);
+        spdlog::info("Unregistered client: {}", name);
+    }
 }
 
 std::shared_ptr<Session> Server::getClientSession(const std::string& name)
@@ -33,12 +69,88 @@ std::shared_ptr<Session> Server::getClientSession(const std::string& name)
 void Server::accept()
 {
     _acceptor.async_accept(
-        [this](boost::system::error_code ec, boost::asio::ip::tcp::socket socket)
+        boost::asio::make_strand(_acceptor.get_executor()),
+        [this](boost::system::error_code ec, auto socket)
         {
             if (!ec)
             {
+                socket.set_option(boost::asio::ip::tcp::no_delay(true));
                 std::make_shared<Session>(std::move(socket), *this)->start();
             }
             accept();
         });
 }
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+void Server::acceptLocal()
+{
+    _localAcceptor->async_accept(boost::asio::make_strand(_acceptor.get_executor()),
+                                 [this](boost::system::error_code ec, auto socket)
+                                 {
+                                     if (!ec)
+                                     {
+                                         std::make_shared<Session>(std::move(socket), *this)
+                                             ->start();
+                                     }
+                                     acceptLocal();
+                                 });
+}
+#endif
+
+#if defined(__linux__)
+void Server::acceptSharedMemory()
+{
+    _shmAcceptor->async_accept(
+        boost::asio::make_strand(_acceptor.get_executor()),
+        [this](boost::system::error_code ec, auto socket)
+        {
+            if (!ec)
+            {
+                // The client passes the ring memfd and the eventfd doorbell right after connect.
+                auto pending = std::make_shared<decltype(socket)>(std::move(socket));
+
+                // A peer that connects and never sends them must not hold the socket forever.
+                auto timer = std::make_shared<boost::asio::steady_timer>(pending->get_executor(),
+                                                                         handshakeTimeout);
+                timer->async_wait(
+                    [pending](boost::system::error_code ec)
+                    {
+                        if (!ec)
+                        {
+                            boost::system::error_code ignored;
+                            pending->close(ignored);
+                        }
+                    });
+
+                pending->async_wait(
+                    boost::asio::socket_base::wait_read,
+                    [this, pending, timer](boost::system::error_code ec)
+                    {
+                        timer->cancel();
+
+                        UniqueFd memFd;
+                        UniqueFd eventFd;
+                        if (ec
+                            || !ShmRing::receiveDescriptors(pending->native_handle(), memFd,
+                                                            eventFd))
+                        {
+                            spdlog::warn("Shared memory client did not pass ring descriptors");
+                            return;
+                        }
+
+                        try
+                        {
+                            auto session = std::make_shared<Session>(std::move(*pending), *this);
+                            session->attachRing(std::move(memFd), std::move(eventFd));
+                            session->start();
+                        }
+                        catch (const std::exception& e)
+                        {
+                            spdlog::error("Failed to attach shared memory ring: {}", e.what());
+                        }
+                    });
+            }
+            acceptSharedMemory();
+        });
+}
+#endif
@@ -2,6 +2,8 @@
 
 #include <boost/asio.hpp>
 
+#include <optional>
+
 class Session;
 
 class Server
@@ -9,15 +11,40 @@ class Server
 public:
     Server(boost::asio::io_context& io_context, short port);
 
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+    // Extra listener for clients running on the same host, skips the TCP loopback path.
+    void listenLocal(const std::string& path);
+#endif
+
+#if defined(__linux__)
+    // Control socket for same-host producers that push messages through a shared memory ring.
+    void listenSharedMemory(const std::string& path);
+#endif
+
     void registerClient(const std::string& name, std::shared_ptr<Session> session);
-    void unregisterClient(const std::string& name);
+    // Only removes the entry if it still points at this session, a newer one may own the name.
+    void unregisterClient(const std::string& name, const Session* session);
     std::shared_ptr<Session> getClientSession(const std::string& name);
 
 private:
     void accept();
 
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+    void acceptLocal();
+#endif
+
+#if defined(__linux__)
+    void acceptSharedMemory();
+#endif
+
 private:
     std::mutex _mutex;
     boost::asio::ip::tcp::acceptor _acceptor;
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+    std::optional<boost::asio::local::stream_protocol::acceptor> _localAcceptor;
+#endif
+#if defined(__linux__)
+    std::optional<boost::asio::local::stream_protocol::acceptor> _shmAcceptor;
+#endif
     std::unordered_map<std::string, std::shared_ptr<Session>> _clients;
 };
\ No newline at end of file
@@ -2,19 +2,48 @@
 
 #include <nlohmann/json.hpp>
 #include <spdlog/spdlog.h>
+#include <cstdlib>
+#include <filesystem>
 #include <fstream>
 #include <memory>
 
+#if defined(__linux__)
+#include "ShmRing.h"
+#endif
+
 // TEST
+#if defined(_WIN32)
 #include <shlobj.h>
 #include <windows.h>
+#endif
 
-Session::Session(boost::asio::ip::tcp::socket socket, Server& server)
+Session::Session(boost::asio::generic::stream_protocol::socket socket, Server& server)
     : _socket(std::move(socket)), _server(server)
 {
 }
 
-void Session::start() { readHeader(); }
+Session::~Session() = default;
+
+#if defined(__linux__)
+void Session::attachRing(UniqueFd memFd, UniqueFd eventFd)
+{
+    _ring = ShmRing::attach(std::move(memFd));
+    _doorbell.emplace(_socket.get_executor());
+    _doorbell->assign(eventFd.get());
+    eventFd.release();
+}
+#endif
+
+void Session::start()
+{
+    readHeader();
+#if defined(__linux__)
+    if (_ring)
+    {
+        readDoorbell();
+    }
+#endif
+}
 
 void Session::readHeader()
 {
@@ -27,6 +56,10 @@ void Session::readHeader()
                                     _data.resize(_dataLen);
                                     readBody();
                                 }
+                                else
+                                {
+                                    stop();
+                                }
                             });
 }
 
@@ -42,35 +75,190 @@ void Session::readBody()
                                     spdlog::info("Raw data size: {}", _data.size());
                                     spdlog::info("JSON preview: {}", json_text.substr(0, 200));
 
-                                    try
-                                    {
-                                        handleMessage(json_text);
-                                    }
-                                    catch (const std::exception& e)
+#if defined(__linux__)
+                                    if (_ring)
                                     {
-                                        spdlog::error("Message processing failed: {}", e.what());
+                                        handleRingSocketFrame(std::move(json_text));
+                                        return;
                                     }
+#endif
 
+                                    processFrame(json_text);
                                     readHeader();
                                 }
                                 else
                                 {
                                     spdlog::error("Read error: {}", ec.message());
+                                    stop();
                                 }
                             });
 }
 
+void Session::processFrame(const std::string& json_text)
+{
+    try
+    {
+        handleMessage(json_text);
+    }
+    catch (const std::exception& e)
+    {
+        spdlog::error("Message processing failed: {}", e.what());
+    }
+}
+
+void Session::stop()
+{
+    if (!_clientName.empty())
+    {
+        _server.unregisterClient(_clientName, this);
+    }
+
+#if defined(__linux__)
+    // Ends the doorbell chain so the mapping, memfd and eventfd go away with the session.
+    if (_doorbell)
+    {
+        _doorbell->close();
+    }
+    _ring.reset();
+#endif
+}
+
+#if defined(__linux__)
+void Session::handleRingSocketFrame(std::string json_text)
+{
+    // A ring client announces every socket frame with an empty marker frame in the ring.
+    // Hold the socket frame until the ring reaches its marker so both channels keep order.
+    // The marker is published before the socket write, so an empty ring means there is none.
+    if (!_awaitingSocketFrame && !_ring->empty())
+    {
+        _deferredFrame = std::move(json_text);
+        return;
+    }
+
+    const bool resumeRing = _awaitingSocketFrame;
+    _awaitingSocketFrame = false;
+    processFrame(json_text);
+    readHeader();
+    if (resumeRing)
+    {
+        drainRing();
+    }
+}
+
+void Session::releaseDeferredFrame()
+{
+    if (_deferredFrame)
+    {
+        processFrame(*_deferredFrame);
+        _deferredFrame.reset();
+        readHeader();
+    }
+}
+
+void Session::readDoorbell()
+{
+    // Keeps the session alive while the socket side waits for a marker; stop() ends the chain.
+    auto self = shared_from_this();
+    _doorbell->async_read_some(boost::asio::buffer(&_doorbellCount, sizeof(_doorbellCount)),
+                               [this, self](boost::system::error_code ec, std::size_t)
+                               {
+                                   if (!ec)
+                                   {
+                                       drainRing();
+                                   }
+                                   else if (ec != boost::asio::error::operation_aborted)
+                                   {
+                                       spdlog::error("Doorbell read error: {}", ec.message());
+                                   }
+                               });
+}
+
+void Session::drainRing()
+{
+    // Bounded batch so a busy producer cannot starve the socket side of this session.
+    constexpr int batchSize = 256;
+
+    if (!_ring)
+    {
+        return;
+    }
+
+    try
+    {
+        for (int i = 0; i < batchSize; ++i)
+        {
+            std::optional<std::string> json_text = _ring->tryPop();
+            if (!json_text)
+            {
+                // A held socket frame had no marker, do not stall the socket on it.
+                releaseDeferredFrame();
+                readDoorbell();
+                return;
+            }
+
+            if (json_text->empty())
+            {
+                if (!_deferredFrame)
+                {
+                    // handleRingSocketFrame() resumes the ring once the socket frame arrives.
+                    _awaitingSocketFrame = true;
+                    return;
+                }
+                releaseDeferredFrame();
+                continue;
+            }
+
+            processFrame(*json_text);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        spdlog::error("Shared memory ring corrupted: {}", e.what());
+        _doorbell->close();
+        _ring.reset();
+        releaseDeferredFrame();
+        return;
+    }
+
+    boost::asio::post(_socket.get_executor(), [this, self = shared_from_this()]() { drainRing(); });
+}
+#endif
+
 void Session::sendRaw(const std::string& data)
 {
     uint32_t len = data.size();
-    std::vector<boost::asio::const_buffer> buffers
-        = { boost::asio::buffer(&len, sizeof(len)), boost::asio::buffer(data) };
-    boost::asio::async_write(_socket, buffers,
-                             [](boost::system::error_code ec, std::size_t)
+    std::string frame(reinterpret_cast<const char*>(&len), sizeof(len));
+    frame += data;
+
+    // Called from other sessions, so hop onto this session's strand before touching the queue.
+    boost::asio::post(_socket.get_executor(),
+                      [this, self = shared_from_this(), frame = std::move(frame)]() mutable
+                      {
+                          _writeQueue.push_back(std::move(frame));
+                          if (_writeQueue.size() == 1)
+                          {
+                              writeNext();
+                          }
+                      });
+}
+
+void Session::writeNext()
+{
+    auto self = shared_from_this();
+    boost::asio::async_write(_socket, boost::asio::buffer(_writeQueue.front()),
+                             [this, self](boost::system::error_code ec, std::size_t)
                              {
                                  if (ec)
                                  {
                                      spdlog::error("Failed to send message: {}", ec.message());
+                                     _writeQueue.clear();
+                                     return;
+                                 }
+
+                                 _writeQueue.pop_front();
+                                 if (!_writeQueue.empty())
+                                 {
+                                     writeNext();
                                  }
                              });
 }
@@ -124,12 +312,13 @@ void Session::processFile(const std::string& sender, const std::string& receiver
                           const std::string& filename_raw, const std::vector<unsigned char>& data)
 {
     std::string filename = sanitizeFilename(filename_raw);
-    std::string full_path = getDesktopPath() + "\\Received from client " + filename;
+    const std::filesystem::path full_path
+        = getDesktopPath() / ("Received from client " + filename);
 
     std::ofstream out(full_path, std::ios::binary);
     if (!out)
     {
-        spdlog::error("Cannot open file for writing: {}", full_path);
+        spdlog::error("Cannot open file for writing: {}", full_path.string());
         return;
     }
 
@@ -209,16 +398,24 @@ std::vector<unsigned char> Session::base64Decode(std::string const& encoded_stri
     return ret;
 }
 
-std::string Session::getDesktopPath()
+std::filesystem::path Session::getDesktopPath()
 {
+#if defined(_WIN32)
     PWSTR path_tmp;
     HRESULT hr = SHGetKnownFolderPath(FOLDERID_Desktop, 0, nullptr, &path_tmp);
     if (SUCCEEDED(hr))
     {
-        char path_utf8[MAX_PATH];
-        wcstombs(path_utf8, path_tmp, MAX_PATH);
+        std::filesystem::path path(path_tmp);
         CoTaskMemFree(path_tmp);
-        return std::string(path_utf8);
+        return path;
+    }
+#else
+    if (const char* home = std::getenv("HOME"))
+    {
+        const std::filesystem::path desktop = std::filesystem::path(home) / "Desktop";
+        std::error_code ec;
+        return std::filesystem::is_directory(desktop, ec) ? desktop : std::filesystem::path(home);
     }
-    return ".";
+#endif
+    return std::filesystem::current_path();
 }
@@ -4,18 +4,47 @@
 
 #include <boost/asio.hpp>
 
+#include <deque>
+#include <filesystem>
+#include <optional>
+
+#if defined(__linux__)
+#include "UniqueFd.h"
+
+class ShmRing;
+#endif
+
 class Session : public std::enable_shared_from_this<Session>
 {
 public:
-    Session(boost::asio::ip::tcp::socket socket, Server& server);
+    // Any stream socket works here: TCP, Unix domain, or the control socket of a ring client.
+    Session(boost::asio::generic::stream_protocol::socket socket, Server& server);
+    ~Session();
+
+#if defined(__linux__)
+    // Messages pushed into the ring go through the same handleMessage() as socket frames,
+    // replies still go over the socket.
+    void attachRing(UniqueFd memFd, UniqueFd eventFd);
+#endif
 
     void start();
 
 private:
     void readHeader();
     void readBody();
+    // Called when the socket fails: releases the ring and the registered name.
+    void stop();
+    void processFrame(const std::string& json_text);
+
+#if defined(__linux__)
+    void handleRingSocketFrame(std::string json_text);
+    void releaseDeferredFrame();
+    void readDoorbell();
+    void drainRing();
+#endif
 
     void sendRaw(const std::string& data);
+    void writeNext();
 
     bool is_base64(unsigned char c);
     void handleMessage(const std::string& json_text);
@@ -28,12 +57,21 @@ private:
     std::vector<unsigned char> base64Decode(std::string const& encoded_string);
 
     // TEST
-    std::string getDesktopPath();
+    std::filesystem::path getDesktopPath();
 
 private:
     Server& _server;
     uint32_t _dataLen = 0;
     std::vector<char> _data;
     std::string _clientName;
-    boost::asio::ip::tcp::socket _socket;
+    boost::asio::generic::stream_protocol::socket _socket;
+    std::deque<std::string> _writeQueue;
+#if defined(__linux__)
+    std::unique_ptr<ShmRing> _ring;
+    std::optional<boost::asio::posix::stream_descriptor> _doorbell;
+    uint64_t _doorbellCount = 0;
+    // Ordering between ring frames and socket frames of a ring client.
+    bool _awaitingSocketFrame = false;
+    std::optional<std::string> _deferredFrame;
+#endif
 };
\ No newline at end of file
@@ -0,0 +1,253 @@
+#include "ShmRing.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+// Covers the parts of ShmRing that parse data written by the other process.
+
+namespace
+{
+    int failures = 0;
+
+#define CHECK(condition)                                                                           \
+    do                                                                                             \
+    {                                                                                              \
+        if (!(condition))                                                                          \
+        {                                                                                          \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK failed: " #condition << std::endl; \
+            ++failures;                                                                            \
+        }                                                                                          \
+    } while (false)
+
+    constexpr std::size_t capacity = 64;
+    // Layout of ShmRing::Header: head and tail each on their own cache line.
+    constexpr std::size_t headOffset = 0;
+    constexpr std::size_t tailOffset = 64;
+    constexpr std::size_t dataOffset = 128;
+
+    struct Pair
+    {
+        std::unique_ptr<ShmRing> producer;
+        std::unique_ptr<ShmRing> consumer;
+    };
+
+    Pair makePair()
+    {
+        Pair pair;
+        pair.producer = ShmRing::create(capacity);
+        pair.consumer = ShmRing::attach(UniqueFd(dup(pair.producer->fd())));
+        return pair;
+    }
+
+    // A second view of the segment, standing in for a misbehaving producer.
+    class PeerMapping
+    {
+    public:
+        explicit PeerMapping(const ShmRing& ring)
+        {
+            _size = dataOffset + ring.capacity();
+            _mapping = static_cast<unsigned char*>(
+                mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_SHARED, ring.fd(), 0));
+        }
+        ~PeerMapping() { munmap(_mapping, _size); }
+
+        void write(std::size_t offset, const void* src, std::size_t size)
+        {
+            std::memcpy(_mapping + offset, src, size);
+        }
+
+    private:
+        unsigned char* _mapping = nullptr;
+        std::size_t _size = 0;
+    };
+
+    bool throws(const std::function<void()>& action)
+    {
+        try
+        {
+            action();
+        }
+        catch (const std::exception&)
+        {
+            return true;
+        }
+        return false;
+    }
+
+    void pushAndPop()
+    {
+        Pair pair = makePair();
+        bool wasEmpty = false;
+
+        CHECK(pair.producer->tryPush("first", wasEmpty));
+        CHECK(wasEmpty);
+        CHECK(pair.producer->tryPush("second", wasEmpty));
+        CHECK(!wasEmpty);
+
+        CHECK(pair.consumer->tryPop() == "first");
+        CHECK(pair.consumer->tryPop() == "second");
+        CHECK(!pair.consumer->tryPop());
+        CHECK(pair.producer->empty());
+    }
+
+    void frameSplitAcrossEnd()
+    {
+        Pair pair = makePair();
+        bool wasEmpty = false;
+
+        // Payload wraps: frame occupies [44, 78).
+        CHECK(pair.producer->tryPush(std::string(40, 'a'), wasEmpty));
+        CHECK(pair.consumer->tryPop() == std::string(40, 'a'));
+        const std::string wrapped = "payload that crosses the end";
+        CHECK(pair.producer->tryPush(wrapped, wasEmpty));
+        CHECK(pair.consumer->tryPop() == wrapped);
+
+        // Length prefix wraps: move to offset 62 so the uint32_t spans the boundary.
+        CHECK(pair.producer->tryPush(std::string(44, 'b'), wasEmpty));
+        CHECK(pair.consumer->tryPop() == std::string(44, 'b'));
+        CHECK(pair.producer->tryPush("abcdef", wasEmpty));
+        CHECK(pair.consumer->tryPop() == "abcdef");
+    }
+
+    void fullRingRejectsPush()
+    {
+        Pair pair = makePair();
+        bool wasEmpty = false;
+
+        CHECK(pair.producer->tryPush(std::string(capacity - sizeof(uint32_t), 'x'), wasEmpty));
+        CHECK(!pair.producer->tryPush("", wasEmpty));
+        CHECK(!pair.producer->tryPush(std::string(capacity, 'x'), wasEmpty));
+
+        CHECK(pair.consumer->tryPop());
+        CHECK(pair.producer->tryPush("again", wasEmpty));
+    }
+
+    void corruptPositionsThrow()
+    {
+        Pair pair = makePair();
+        PeerMapping peer(*pair.producer);
+
+        const uint64_t tooFar = capacity + 1;
+        peer.write(headOffset, &tooFar, sizeof(tooFar));
+        CHECK(throws([&] { pair.consumer->tryPop(); }));
+
+        const uint64_t shorterThanLength = 2;
+        peer.write(headOffset, &shorterThanLength, sizeof(shorterThanLength));
+        CHECK(throws([&] { pair.consumer->tryPop(); }));
+
+        const uint64_t tailAhead = 10;
+        const uint64_t head = 0;
+        peer.write(headOffset, &head, sizeof(head));
+        peer.write(tailOffset, &tailAhead, sizeof(tailAhead));
+        CHECK(throws([&] { pair.consumer->tryPop(); }));
+    }
+
+    void corruptLengthThrows()
+    {
+        Pair pair = makePair();
+        PeerMapping peer(*pair.producer);
+        bool wasEmpty = false;
+
+        CHECK(pair.producer->tryPush("hello", wasEmpty));
+        const uint32_t len = 1000;
+        peer.write(dataOffset, &len, sizeof(len));
+        CHECK(throws([&] { pair.consumer->tryPop(); }));
+    }
+
+    void attachRejectsUnsealedOrMisSizedSegments()
+    {
+        UniqueFd unsealed(memfd_create("unsealed", MFD_CLOEXEC));
+        CHECK(ftruncate(unsealed.get(), dataOffset + capacity) == 0);
+        CHECK(throws([&] { ShmRing::attach(std::move(unsealed)); }));
+
+        UniqueFd oddSize(memfd_create("odd-size", MFD_CLOEXEC | MFD_ALLOW_SEALING));
+        CHECK(ftruncate(oddSize.get(), dataOffset + 100) == 0);
+        CHECK(fcntl(oddSize.get(), F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL) == 0);
+        CHECK(throws([&] { ShmRing::attach(std::move(oddSize)); }));
+
+        auto ring = ShmRing::create(capacity);
+        CHECK(ftruncate(ring->fd(), 0) != 0);
+    }
+
+    void sendFds(int socketFd, const std::vector<int>& fds)
+    {
+        char byte = 0;
+        iovec iov{ &byte, sizeof(byte) };
+        std::vector<char> control(CMSG_SPACE(fds.size() * sizeof(int)));
+
+        msghdr msg{};
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        if (!fds.empty())
+        {
+            msg.msg_control = control.data();
+            msg.msg_controllen = control.size();
+            cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+            cmsg->cmsg_level = SOL_SOCKET;
+            cmsg->cmsg_type = SCM_RIGHTS;
+            cmsg->cmsg_len = CMSG_LEN(fds.size() * sizeof(int));
+            std::memcpy(CMSG_DATA(cmsg), fds.data(), fds.size() * sizeof(int));
+        }
+
+        if (sendmsg(socketFd, &msg, 0) != sizeof(byte))
+        {
+            throw std::runtime_error("sendmsg failed");
+        }
+    }
+
+    bool receiveCount(std::size_t count)
+    {
+        int sockets[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) != 0)
+        {
+            throw std::runtime_error("socketpair failed");
+        }
+        UniqueFd sender(sockets[0]);
+        UniqueFd receiver(sockets[1]);
+
+        std::vector<int> fds(count, STDIN_FILENO);
+        sendFds(sender.get(), fds);
+
+        UniqueFd memFd;
+        UniqueFd eventFd;
+        const bool received = ShmRing::receiveDescriptors(receiver.get(), memFd, eventFd);
+        CHECK(received == (memFd && eventFd));
+        return received;
+    }
+
+    void receiveDescriptorsChecksCount()
+    {
+        CHECK(!receiveCount(0));
+        CHECK(!receiveCount(1));
+        CHECK(receiveCount(2));
+        CHECK(!receiveCount(3));
+    }
+} // namespace
+
+int main()
+{
+    pushAndPop();
+    frameSplitAcrossEnd();
+    fullRingRejectsPush();
+    corruptPositionsThrow();
+    corruptLengthThrows();
+    attachRejectsUnsealedOrMisSizedSegments();
+    receiveDescriptorsChecksCount();
+
+    if (failures != 0)
+    {
+        std::cerr << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "All ShmRing tests passed" << std::endl;
+    return 0;
+}
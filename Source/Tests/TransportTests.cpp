@@ -0,0 +1,155 @@
+#include "Client.h"
+#include "Server.h"
+
+#include <spdlog/spdlog.h>
+
+#include <unistd.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <thread>
+
+// Runs a Server in-process and talks to it through the same-host transports.
+
+namespace
+{
+    int failures = 0;
+
+#define CHECK(condition)                                                                           \
+    do                                                                                             \
+    {                                                                                              \
+        if (!(condition))                                                                          \
+        {                                                                                          \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK failed: " #condition << std::endl; \
+            ++failures;                                                                            \
+        }                                                                                          \
+    } while (false)
+
+    const std::string localPath = "/tmp/ClientServer-test-" + std::to_string(getpid()) + ".sock";
+    const std::string shmPath = "/tmp/ClientServer-test-" + std::to_string(getpid()) + ".shm.sock";
+
+    bool waitUntil(const std::function<bool()>& condition)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (!condition())
+        {
+            if (std::chrono::steady_clock::now() > deadline)
+            {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+
+    struct Received
+    {
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::vector<std::size_t> sizes;
+    };
+
+    // A message too big for the ring goes over the control socket; the ring messages before and
+    // after it must still be routed in the order the client sent them.
+    void oversizedMessageKeepsOrder(Server& server)
+    {
+        constexpr int rounds = 10;
+
+        Received received;
+        Client rx{ std::filesystem::path(localPath) };
+        rx.setName("rx");
+        rx.setMessageHandler(
+            [&received](const nlohmann::json& msg)
+            {
+                std::lock_guard<std::mutex> lock(received.mutex);
+                received.sizes.push_back(msg["data"].get<std::string>().size());
+                received.cv.notify_one();
+            });
+        rx.registerName();
+        rx.startReceiving();
+        std::thread rxThread([&rx]() { rx.run(); });
+        CHECK(waitUntil([&server]() { return server.getClientSession("rx") != nullptr; }));
+
+        Client tx(std::filesystem::path(shmPath), Client::Transport::SharedMemory);
+        tx.setName("tx");
+        tx.registerName();
+        // Base64 inflates it past the default 1 MiB ring.
+        const std::string big(800 * 1024, 'b');
+        for (int i = 0; i < rounds; ++i)
+        {
+            tx.sendText("rx", big);
+            tx.sendText("rx", "small");
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(received.mutex);
+            CHECK(received.cv.wait_for(lock, std::chrono::seconds(30),
+                                       [&]() { return received.sizes.size() == 2 * rounds; }));
+            for (std::size_t i = 0; i < received.sizes.size(); ++i)
+            {
+                const bool expectBig = i % 2 == 0;
+                CHECK((received.sizes[i] > big.size()) == expectBig);
+            }
+        }
+
+        rx.stop();
+        rxThread.join();
+    }
+
+    void disconnectUnregistersRingClient(Server& server)
+    {
+        {
+            Client tx(std::filesystem::path(shmPath), Client::Transport::SharedMemory);
+            tx.setName("leaving");
+            tx.registerName();
+            CHECK(waitUntil([&server]() { return server.getClientSession("leaving") != nullptr; }));
+        }
+        CHECK(waitUntil([&server]() { return server.getClientSession("leaving") == nullptr; }));
+    }
+} // namespace
+
+int main()
+{
+    spdlog::set_level(spdlog::level::warn);
+
+    boost::asio::io_context io_context;
+    Server server(io_context, 0);
+    server.listenLocal(localPath);
+    server.listenSharedMemory(shmPath);
+
+    auto work = boost::asio::make_work_guard(io_context);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 2; ++i)
+    {
+        threads.emplace_back([&io_context]() { io_context.run(); });
+    }
+
+    try
+    {
+        oversizedMessageKeepsOrder(server);
+        disconnectUnregistersRingClient(server);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Unexpected exception: " << e.what() << std::endl;
+        ++failures;
+    }
+
+    io_context.stop();
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+    std::filesystem::remove(localPath);
+    std::filesystem::remove(shmPath);
+
+    if (failures != 0)
+    {
+        std::cerr << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "All transport tests passed" << std::endl;
+    return 0;
+}